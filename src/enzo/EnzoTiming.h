@@ -28,6 +28,9 @@
 #include <string>
 #include <cstring>
 #include <map>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 template <typename T>
 bool min(const T& A, const T& B) {
@@ -192,14 +195,22 @@ namespace enzo_timing{
       return;
     }
 
-    // Start a timer by name
+    // Start a timer by name.  Timers are not thread-safe, so calls
+    // made from inside a threaded grid loop are ignored; the enclosing
+    // level timer still accounts for the time.
     void start(char *name){
+#ifdef USE_OPENMP
+      if (omp_in_parallel()) return;
+#endif
       this->create(name);
       timers[name]->start();
     }
 
     // Stop a timer by name
     void stop(char *name){
+#ifdef USE_OPENMP
+      if (omp_in_parallel()) return;
+#endif
       timers[name]->stop();
     }
 
@@ -0,0 +1,81 @@
+/***********************************************************************
+/
+/  EULER SWEEP SCRATCH ARENA
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: Holds the slice and flux temporaries used by the
+/    direct-Euler PPM sweeps (grid::[xyz]EulerSweep).  All arrays are
+/    carved out of one aligned allocation that is kept per thread and
+/    only grows, so a sweep does not touch the heap once the largest
+/    slice has been seen.
+/
+/    PencilBlock() returns how many pencils (1D lines along the sweep
+/    direction) of a slice are processed together, so that the working
+/    set of one block fits in cache (see PPMPencilBlockSize).
+/
+************************************************************************/
+
+#ifndef EULER_SWEEP_SCRATCH_DEFINED__
+#define EULER_SWEEP_SCRATCH_DEFINED__
+
+/* Alignment (bytes) of each array in the arena, and the target working
+   set (bytes) of one block of pencils when PPMPencilBlockSize = 0. */
+
+#define EULER_SWEEP_ALIGN 64
+#define EULER_SWEEP_CACHE_BYTES 262144
+
+/* Number of full-slice arrays (not counting colours) and the number of
+   colour arrays per colour field. */
+
+#define EULER_SWEEP_NUMBER_OF_ARRAYS 31
+#define EULER_SWEEP_NUMBER_OF_COLOUR_ARRAYS 4
+
+class EulerSweepScratch
+{
+
+ public:
+
+  /* slice data */
+
+  float *dslice, *eslice, *uslice, *vslice, *wslice, *grslice, *geslice,
+    *pslice, *colslice;
+
+  /* interface states and fluxes */
+
+  float *dls, *drs, *flatten, *pbar, *pls, *prs, *ubar, *uls, *urs, *vls,
+    *vrs, *gels, *gers, *wls, *wrs, *diffcoef, *df, *ef, *uf, *vf, *wf,
+    *gef, *ges, *colf, *colls, *colrs;
+
+  EulerSweepScratch(void);
+  ~EulerSweepScratch(void);
+
+  /* Make sure every array holds at least size elements (and
+     NumberOfColours*size for the colour arrays). */
+
+  void Reserve(int size, int NumberOfColours);
+
+  /* Number of pencils of length PencilLength to process per block.
+     With explicit diffusion the whole slice is one block, since the
+     diffusion coefficients read the transverse velocities of
+     neighbouring pencils before they are written back. */
+
+  int PencilBlock(int PencilLength, int NumberOfPencils, int NumberOfColours,
+		  int Diffusion);
+
+ private:
+
+  float *Arena;
+  int ArenaSize;
+  int SliceSize;
+  int ColourCount;
+
+};
+
+/* Returns the arena belonging to the calling thread. */
+
+EulerSweepScratch *GetEulerSweepScratch(void);
+
+#endif
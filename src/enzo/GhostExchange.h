@@ -0,0 +1,31 @@
+/***********************************************************************
+/
+/  GHOST ZONE EXCHANGE SCHEDULE
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: One region of the aggregated sibling ghost zone exchange
+/    (see CommunicationExchangeGhostZones).  ToGrid receives the
+/    zones Start..Start+Dim-1 from the zones StartOther..StartOther+
+/    Dim-1 of FromGrid, which CheckForOverlap has moved by EdgeOffset.
+/
+************************************************************************/
+
+#ifndef GHOST_EXCHANGE_DEFINED__
+#define GHOST_EXCHANGE_DEFINED__
+
+struct GhostExchangeRegion {
+  grid *ToGrid;
+  grid *FromGrid;
+  int Start[MAX_DIMENSION];
+  int StartOther[MAX_DIMENSION];
+  int Dim[MAX_DIMENSION];
+  FLOAT EdgeOffset[MAX_DIMENSION];
+};
+
+void GhostExchangeAddRegion(GhostExchangeRegion &Region, int ToProcessor,
+			    int FromProcessor);
+
+#endif
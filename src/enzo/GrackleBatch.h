@@ -0,0 +1,60 @@
+/***********************************************************************
+/
+/  GRACKLE LEVEL BATCH
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: With GrackleLevelBatch, the active cells of all grids of a
+/    level are gathered into contiguous 1D chunks of about
+/    GrackleBatchSize cells, solve_chemistry is called once per chunk
+/    (the chunks are spread over the OpenMP threads) and the results
+/    are scattered back (see GrackleSolveLevel.C).
+/
+/    GrackleBatchGrid describes the fields of one grid taking part in
+/    the batch.  It is filled by grid::GrackleBatchPrepare and released
+/    by grid::GrackleBatchFinish, which also updates the total energy.
+/
+************************************************************************/
+
+#ifndef GRACKLE_BATCH_DEFINED__
+#define GRACKLE_BATCH_DEFINED__
+
+/* Fields passed to grackle.  Those up to GrackleBatchLastOutput are
+   updated by solve_chemistry and scattered back to the grid. */
+
+enum GrackleBatchFieldIndex {
+  gbInternalEnergy, gbHI, gbHII, gbHeI, gbHeII, gbHeIII, gbDe,
+  gbHM, gbH2I, gbH2II, gbDI, gbDII, gbHDI,
+  gbDensity, gbVelocity1, gbVelocity2, gbVelocity3, gbMetal,
+  gbRTkphHI, gbRTkphHeI, gbRTkphHeII, gbRTkdissH2I, gbRTgamma,
+  GRACKLE_BATCH_NUMBER_OF_FIELDS
+};
+
+const int GrackleBatchLastOutput = gbHDI;
+
+struct GrackleBatchGrid {
+
+  int Active;                     // FALSE if the grid is not on this processor
+  FLOAT Time;
+  float dtFixed;
+  FLOAT CellWidth;
+  int GridDimension[MAX_DIMENSION];
+  int GridStartIndex[MAX_DIMENSION];
+  int GridEndIndex[MAX_DIMENSION];
+
+  /* BaryonField (or temporary) arrays, NULL when not used, and the
+     factor applied while gathering (RT units to CGS). */
+
+  float *Fields[GRACKLE_BATCH_NUMBER_OF_FIELDS];
+  float Scale[GRACKLE_BATCH_NUMBER_OF_FIELDS];
+
+  /* owned temporaries */
+
+  float *ThermalEnergy;
+  float *TotalMetals;
+
+};
+
+#endif
@@ -68,6 +68,8 @@ int FindField(int f, int farray[], int n);
 struct LevelHierarchyEntry;
 class ActiveParticleType;
 class ActiveParticle_AccretingParticle;
+class EulerSweepScratch;
+struct GrackleBatchGrid;
 
 class grid
 {
@@ -100,6 +102,10 @@ class grid
   int    NumberOfBaryonFields;                        // active baryon fields
   float *BaryonField[MAX_NUMBER_OF_BARYON_FIELDS];    // pointers to arrays
   float *OldBaryonField[MAX_NUMBER_OF_BARYON_FIELDS]; // pointers to old arrays
+  float *BaryonFieldSlab;      // one allocation holding BaryonField[] (or NULL)
+  int    BaryonFieldSlabSize;
+  float *OldBaryonFieldSlab;   // same for OldBaryonField[]
+  int    OldBaryonFieldSlabSize;
   float *InterpolatedField[MAX_NUMBER_OF_BARYON_FIELDS]; // For RT and movies
   float *RandomForcingField[MAX_DIMENSION];           // pointers to arrays //AK
   int    FieldType[MAX_NUMBER_OF_BARYON_FIELDS];
@@ -200,9 +206,16 @@ class grid
   float *MassFlaggingField;         // Used by mass flagging criteria
   float *ParticleMassFlaggingField; // Used by particle mass flagging criteria
 //
+//  Subcycles taken by each cell in the last batched rate/cool solve
+//  (RateCoolBatchSize); used to order the cells of the next one.
+//
+  int   *RateCoolSubcycles;
+//
 //  Parallel Information
 //
   int ProcessorNumber;
+  double MeasuredCost;       // wall time of the last update of this grid
+  double MeasuredCostCells;  // cells of a new grid covered by old grids
 //
 // Movie Data Format
 //
@@ -552,6 +565,7 @@ public:
 /* set time of this grid (used in setup) */
 
    void SetTime(FLOAT NewTime) {Time = NewTime;};
+   void SetOldTime(FLOAT NewTime) {OldTime = NewTime;};
 
 /* set hydro parameters (used in setup) */
 
@@ -739,6 +753,12 @@ gradient force to gravitational force for one-zone collapse test. */
 
    int GrackleWrapper();
 
+/* Describe this grid for, and finish it after, a level-wide grackle
+   batch (GrackleSolveLevel). */
+
+   int GrackleBatchPrepare(GrackleBatchGrid *Batch);
+   int GrackleBatchFinish(GrackleBatchGrid *Batch);
+
 /* Handle the selection of shock finding algorithm */
 
    int ShocksHandler();
@@ -1079,6 +1099,18 @@ gradient force to gravitational force for one-zone collapse test. */
 
    int CopyZonesFromGridCountOnly(grid *GridOnSameLevel, int &Overlap);
 
+/* baryons: add the zones CopyZonesFromGrid would copy from the grid in
+   the argument to the ghost zone exchange schedule being built. */
+
+   int AddGhostExchangeRegion(grid *GridOnSameLevel,
+			      FLOAT EdgeOffset[MAX_DIMENSION]);
+
+/* baryons: copy all fields in a region of this grid to a buffer, or
+   back from it (Unpack = TRUE).  Returns the number of values. */
+
+   int CopyGhostExchangeRegion(float *Buffer, int Start[], int Dim[],
+			       int Unpack);
+
 /* Returns whether or not the subgrids of this grid are static. */
 
    int AreSubgridsStatic() {return SubgridsAreStatic;};
@@ -1182,9 +1214,35 @@ gradient force to gravitational force for one-zone collapse test. */
 
    int PreparePotentialField(grid *ParentGrid);
 
-/* Gravity: Allocate and make initial guess for PotentialField. */
+/* Gravity: Solve for the PotentialField (with Residual, also returns the
+   relative residual of the initial guess). */
+
+   int SolveForPotential(int level, FLOAT PotentialTime = -1,
+			 float *Residual = NULL);
+
+/* Gravity: right hand side, solution and tolerance of the multigrid
+   solve of SolveForPotential (NULL if there is nothing to solve). */
+
+   float *SetupPotentialSolve(FLOAT PotentialTime, float *&Solution,
+			      float &tolerance);
+
+/* Gravity: relative residual of the PotentialField for rhs. */
+
+   float PotentialResidual(float *rhs);
+
+/* Gravity: start and end indices of the active region in the
+   PotentialField. */
+
+   void PotentialActiveRegion(int Start[], int End[]);
 
-   int SolveForPotential(int level, FLOAT PotentialTime = -1);
+/* Gravity: replace the PotentialField array and return the old one (the
+   level-wide solver exchanges other arrays with CopyPotentialField). */
+
+   float *ReplacePotentialField(float *NewField) {
+     float *OldField = PotentialField;
+     PotentialField = NewField;
+     return OldField;
+   }
 
 /* Gravity: Prepare the Greens Function. */
 
@@ -1631,6 +1689,12 @@ void SortParticlesByNumber();
 void SortActiveParticlesByNumber();
 void SortParticlesByType();
 
+/* Particles: sort particle data in Morton order of their zones, and the
+   range of the particles in zone (i,j,k) once sorted. */
+
+void SortParticlesByCell();
+void FindParticlesInCell(int i, int j, int k, int &First, int &Last);
+
 int CreateParticleTypeGrouping(hid_t ptype_dset,
                                hid_t ptype_dspace,
                                hid_t parent_group,
@@ -1655,6 +1719,17 @@ int CreateParticleTypeGrouping(hid_t ptype_dset,
     return ProcessorNumber;
   }
 
+/* Measured cost for load balancing (LoadBalancingMeasuredCost).  An
+   evolved grid carries the wall time of its last update; a new grid
+   carries the share of the cost of the old grids it overlaps, and the
+   number of its cells that they cover. */
+
+  void ResetMeasuredCost() { MeasuredCost = MeasuredCostCells = 0; };
+  void AddMeasuredCost(double Cost) { MeasuredCost += Cost; };
+  double ReturnMeasuredCost() { return MeasuredCost; };
+  double ReturnMeasuredCostCells() { return MeasuredCostCells; };
+  void InheritMeasuredCost(grid *OldGrid);
+
 /* Send a region from a real grid to a 'fake' grid on another processor. */
 
   int CommunicationSendRegion(grid *ToGrid, int ToProcessor, int SendField, 
@@ -1673,6 +1748,38 @@ int CreateParticleTypeGrouping(hid_t ptype_dset,
 			    int DeleteAllFields = TRUE, 
 			    int MoveSubgridMarker = FALSE);
 
+/* Move the baryon fields of a grid as one slab (for CommunicationMoveGrid). */
+
+  int CommunicationSendBaryonSlab(int ToProcessor);
+
+/* Free a field array, unless it lives in BaryonFieldSlab or
+   OldBaryonFieldSlab (which are freed as a whole when all fields are
+   deleted). */
+
+  void FreeFieldArray(float *&Field) {
+    if ((BaryonFieldSlab == NULL || Field < BaryonFieldSlab ||
+	 Field >= BaryonFieldSlab + BaryonFieldSlabSize) &&
+	(OldBaryonFieldSlab == NULL || Field < OldBaryonFieldSlab ||
+	 Field >= OldBaryonFieldSlab + OldBaryonFieldSlabSize))
+      delete [] Field;
+    Field = NULL;
+  };
+  void FreeBaryonFieldSlab() {
+    delete [] BaryonFieldSlab;
+    BaryonFieldSlab = NULL;
+    BaryonFieldSlabSize = 0;
+  };
+  void FreeOldBaryonFieldSlab() {
+    delete [] OldBaryonFieldSlab;
+    OldBaryonFieldSlab = NULL;
+    OldBaryonFieldSlabSize = 0;
+  };
+
+/* Allocate all (old) baryon fields in one aligned slab (UseBaryonFieldSlab). */
+
+  void AllocateBaryonFieldSlab();
+  void AllocateOldBaryonFieldSlab();
+
 /* Send particles from one grid to another. */
 
   int CommunicationSendParticles(grid *ToGrid, int ToProcessor, 
@@ -1854,15 +1961,18 @@ int SolvePPM_DE(int CycleNumber, int NumberOfSubgrids,
 
 int xEulerSweep(int k, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
-		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
+		int GravityOn, int NumberOfColours, int colnum[], float *pressure,
+		EulerSweepScratch *Scratch);
 
 int yEulerSweep(int i, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
-		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
+		int GravityOn, int NumberOfColours, int colnum[], float *pressure,
+		EulerSweepScratch *Scratch);
 
 int zEulerSweep(int j, int NumberOfSubgrids, fluxes *SubgridFluxes[], 
 		Elong_int GridGlobalStart[], float *CellWidthTemp[], 
-		int GravityOn, int NumberOfColours, int colnum[], float *pressure);
+		int GravityOn, int NumberOfColours, int colnum[], float *pressure,
+		EulerSweepScratch *Scratch);
 
 // AccelerationHack
 
@@ -53,6 +53,12 @@ void DeleteSubgridMarker() { delete [] SubgridMarker; SubgridMarker = NULL; };
 
    int PhotonSortLinkedLists(void);
 
+/* copy the photon lists into an array (releasing the nodes) and back,
+   see CompactPhotonPackages */
+
+   int PhotonPackagesToArray(PhotonPackageEntry* &Array, int *ListCount);
+   int PhotonPackagesFromArray(PhotonPackageEntry* &Array, int *ListCount);
+
 /* Set Subgrid Marker field */
 
    int SetSubgridMarkerFromSubgrid(grid *Subgrid);
@@ -79,36 +85,39 @@ int RadiativeTransferLWShielding(PhotonPackageEntry **PP, FLOAT &dP,
 				 FLOAT thisDensity, FLOAT ddr, 
 				 int cellindex,  float LengthUnits,
 				 int kdissH2INum, int TemperatureField,
-				 float geo_correction);
+				 float geo_correction, float **RateField);
 
 int RadiativeTransferLW(PhotonPackageEntry **PP, FLOAT &dP,
 			int cellindex, float tau, FLOAT photonrate, 
-			float geo_correction, int kdissH2INum);
+			float geo_correction, int kdissH2INum, float **RateField);
 
 int RadiativeTransferH2II(PhotonPackageEntry **PP,
 			  int cellindex, float tau, FLOAT photonrate, 
-			  float geo_correction, int kdissH2IINum);
+			  float geo_correction, int kdissH2IINum,
+			  float **RateField);
 
 
 int RadiativeTransferIR(PhotonPackageEntry **PP, FLOAT &dP,
 			int cellindex, float tau, FLOAT photonrate, 
 			FLOAT *excessrate, float geo_correction, 
-			int kphHMNum, int gammaNum);
+			int kphHMNum, int gammaNum, float **RateField);
 
 int RadiativeTransferIonization(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 				int species, float tau, FLOAT photonrate, 
 				FLOAT *excessrate, float geo_correction,
-				const int *kphNum, int gammaNum);
+				const int *kphNum, int gammaNum, float **RateField);
 
 int RadiativeTransferXRays(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 			   int species, FLOAT ddr, float tau, FLOAT geo_correction,
 			   FLOAT photonrate, FLOAT *excessrate, float *ion_factor2,
-			   float heat_factor, const int *kphNum, int gammaNum);
+			   float heat_factor, const int *kphNum, int gammaNum,
+			   float **RateField);
 
 int RadiativeTransferComptonHeating(PhotonPackageEntry **PP, FLOAT *dPi, int cellindex, 
 				    float LengthUnits, FLOAT photonrate, 
 				    int TemperatureField, FLOAT ddr, double dN, 
-				    float geo_correction, int gammaNum);
+				    float geo_correction, int gammaNum,
+				    float **RateField);
 
 /* Functions to calculate the H2II cross section */
 float LookUpCrossSectionH2II(float hnu, float T);
@@ -158,6 +167,16 @@ int TransportPhotonPackages(int level, int finest_level,
 			    int GridNum, grid **Grids0, int nGrids0, 
 			    grid *ParentGrid, grid *CurrentGrid);
 
+/* Transport the packages with threads drawing from work-stealing
+   deques (see Grid_TransportPhotonPackagesThreaded.C) */
+
+int TransportPhotonPackagesThreaded(int level, ListOfPhotonsToMove **PhotonsToMove,
+				    int GridNum, grid **Grids0, int nGrids0,
+				    grid *ParentGrid, grid *CurrentGrid,
+				    float *DomainWidth, float LightCrossingTime,
+				    float LightSpeed, float MinimumPhotonFlux,
+				    FLOAT EndTime);
+
 int ElectronFractionEstimate(float dt);
 int RadiationPresent(void) { return HasRadiation; }
 void SetRadiation(char value) { HasRadiation = value; }
@@ -451,7 +470,8 @@ int WalkPhotonPackage(PhotonPackageEntry **PP,
 		      grid **MoveToGrid, grid *ParentGrid, grid *CurrentGrid,
 		      grid **Grids0, int nGrids0, int &DeleteMe, int &PauseMe, 
 		      int &DeltaLevel, float LightCrossingTime,float LightSpeed,
-		      int level, float MinimumPhotonFlux);
+		      int level, float MinimumPhotonFlux, float **RateField,
+		      char *IfrontCell);
 
 int FindPhotonNewGrid(int cindex, FLOAT *r, double *u, int *g,
 		      PhotonPackageEntry* &PP,
@@ -8,6 +8,11 @@
 /                Converted into a poor man's class with everything 
 /                public.  I need a constructor/destructor to use the
 /                MemoryPool to avoid memory fragmentation.
+/  modified2:  October, 2026 by Enzo development team
+/                Non-virtual destructor.  Without MEMORY_POOL the
+/                packages live in contiguous slabs (see
+/                PhotonPackageRoutines.C) that CompactPhotonPackages
+/                re-packs when they become sparse.
 /
 /  PURPOSE: Constructs a Linked List of Photon Packages including data
 /
@@ -41,14 +46,13 @@ public:
 
   PhotonPackageEntry(void);
 
-  virtual ~PhotonPackageEntry(void) {};
+  ~PhotonPackageEntry(void) {};
 
-  /* Overloaded new/delete to use the memory pool, if requested */
+  /* Overloaded new/delete to use the memory pool (with MEMORY_POOL)
+     or the package slabs */
 
-#ifdef MEMORY_POOL
   void* operator new(size_t nobjects);
   void operator delete(void* object);
-#endif
 
   void PrintInfo(void) {
     FLOAT r[3];
@@ -66,4 +70,10 @@ public:
   };
 
 };
+
+/* Sort the free package slots and release empty slabs */
+
+void PhotonPackageSlabsCompact(void);
+float PhotonPackageSlabsOccupancy(void);
+
 #endif /* PHOTONPACKAGE_H */
@@ -57,6 +57,11 @@ EXTERN int RadiativeTransferSourceClustering;
 
 EXTERN float RadiativeTransferPhotonMergeRadius;
 
+/* Re-pack the photon package slabs when fewer than this fraction of
+   their slots hold packages (0 = never). */
+
+EXTERN float RadiativeTransferPhotonCompactOccupancy;
+
 /* Radiative pressure flag and scale factor */
 
 EXTERN int RadiationPressure;
@@ -105,6 +110,11 @@ EXTERN char *RadiativeTransferTraceSpectrumTable;
 
 EXTERN int RadiativeTransferLoadBalance;
 
+/* Flag to transport the photon packages of a grid with OpenMP threads
+   and work-stealing (see Grid_TransportPhotonPackagesThreaded.C) */
+
+EXTERN int RadiativeTransferThreadedTransport;
+
 /* Flux threshold when rays are deleted in units of the UV background
    flux (RadiationFieldType > 0) */
 
@@ -0,0 +1,130 @@
+/***********************************************************************
+/
+/  SCRATCH POOL CLASS
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/
+/  PURPOSE: Pool for the temporary work arrays of the grid routines
+/    (interpolation temporaries, temperature fields, ...), which are
+/    otherwise allocated and freed for every grid in every step.
+/
+/    Requests are rounded up to a power-of-two size class, and each
+/    class is served by its own MPool::MemoryPool whose chunks are one
+/    array of that class.  Every thread has its own set of pools, so no
+/    locking is needed.  Freed arrays stay in the pool, so once the
+/    largest grids have been seen a step does not touch the heap.
+/    The pools never shrink: each thread keeps as many arrays of each
+/    class as it has ever had in use at once, until the run ends.
+/
+/    ScratchArray<T> is the handle used by the grid routines: it
+/    returns its array to the pool when it goes out of scope (also
+/    when an ENZO_FAIL unwinds the stack).
+/
+************************************************************************/
+#ifndef __SCRATCHPOOL_H
+#define __SCRATCHPOOL_H
+
+#include <string.h>
+#include "MemoryPool.h"
+
+namespace MPool
+{
+
+  // Smallest and largest size class (log2 of bytes).  Larger arrays
+  // come straight from the heap.
+  static const int SCRATCH_MINIMUM_CLASS = 10;
+  static const int SCRATCH_MAXIMUM_CLASS = 32;
+  static const int SCRATCH_NUMBER_OF_CLASSES =
+    SCRATCH_MAXIMUM_CLASS - SCRATCH_MINIMUM_CLASS + 1;
+
+  class ScratchPool
+  {
+
+  private:
+
+    MemoryPool *Pool[SCRATCH_NUMBER_OF_CLASSES];
+
+    // Arrays held by each pool and arrays handed out
+    size_t Arrays[SCRATCH_NUMBER_OF_CLASSES];
+    size_t ArraysInUse[SCRATCH_NUMBER_OF_CLASSES];
+
+  public:
+
+    ScratchPool(void);
+    ~ScratchPool(void);
+
+    // Returns at least MemorySize bytes and the size class to give
+    // back to FreeMemory (-1 if the memory came from the heap).
+    void* GetMemory(const size_t &MemorySize, int &SizeClass);
+
+    void FreeMemory(void *sMemoryBlock, int SizeClass);
+
+    // Bytes held by the pools of this thread
+    size_t PoolSize(void);
+
+  };
+
+  // The pool of the calling thread
+  ScratchPool *GetScratchPool(void);
+
+  // Bytes held by the pools of all threads.  Call it outside of
+  // parallel regions, since the other pools are read unlocked.
+  size_t ScratchPoolSize(void);
+
+  /* Counters since the last call to ResetScratchCounters (summed over
+     the threads): requests and their bytes, and the requests that had
+     to allocate from the heap and their bytes. */
+
+  void GetScratchCounters(double &Requests, double &RequestedBytes,
+			  double &HeapAllocations, double &HeapBytes);
+  void ResetScratchCounters(void);
+
+  /* Scratch array of n elements of type T, taken from the pool of the
+     calling thread.  With Zero the array is zeroed like new T[n](). */
+
+  template <class T>
+  class ScratchArray
+  {
+
+  private:
+
+    T *Data;
+    int SizeClass;
+    ScratchPool *Owner;
+
+    // not copyable
+    ScratchArray(const ScratchArray &);
+    ScratchArray &operator=(const ScratchArray &);
+
+  public:
+
+    ScratchArray(void) : Data(NULL), SizeClass(-1), Owner(NULL) {};
+    ScratchArray(size_t n, bool Zero = false) :
+      Data(NULL), SizeClass(-1), Owner(NULL) { Allocate(n, Zero); };
+    ~ScratchArray(void) { Release(); };
+
+    T *Allocate(size_t n, bool Zero = false) {
+      Release();
+      Owner = GetScratchPool();
+      Data = (T*) Owner->GetMemory(max(n, (size_t) 1) * sizeof(T), SizeClass);
+      if (Zero)
+	memset(Data, 0, n * sizeof(T));
+      return Data;
+    };
+
+    void Release(void) {
+      if (Data != NULL)
+	Owner->FreeMemory((void*) Data, SizeClass);
+      Data = NULL;
+      Owner = NULL;
+    };
+
+    T *get(void) const { return Data; };
+    operator T*() const { return Data; };
+
+  };
+
+}
+
+#endif
@@ -47,6 +47,7 @@ EXTERN int CoresPerNode;
 EXTERN int PreviousMaxTask;
 EXTERN int LoadBalancingMinLevel;
 EXTERN int LoadBalancingMaxLevel;
+EXTERN int LoadBalancingMeasuredCost;
 
 /* FileDirectedOutput checks for file existence: 
    stopNow (writes, stops),   outputNow, subgridcycleCount */
@@ -305,6 +306,23 @@ EXTERN int CopyGravPotential;
 
 EXTERN int PotentialIterations;
 
+/* Stop the PotentialIterations early once the relative residual of the
+   subgrid potentials before a solve is below this (0 = off). */
+
+EXTERN float PotentialIterationsTolerance;
+
+/* Number of same-shaped subgrids solved together by the multigrid
+   solver (1 = one grid at a time). */
+
+EXTERN int PotentialSolveBatchSize;
+
+/* Solve for the potential of the subgrids of a level on their union
+   (composite grid) instead of grid by grid, and the reduction of the
+   residual norm at which that solve stops. */
+
+EXTERN int CompositePotentialSolve;
+EXTERN float CompositePotentialSolveTolerance;
+
 /* Flag indicating whether or not to use the baryon self-gravity approximation
    (subgrid cells influence are approximated by their projection to the
    current grid). */
@@ -333,6 +351,16 @@ EXTERN int WritePotential;
 
 EXTERN int ParticleSubgridDepositMode;
 
+/* Deposit the particle masses with the tiled, threaded cloud-in-cell
+   routine (DepositParticlesCIC.C) instead of cic_deposit. */
+
+EXTERN int ParticleDepositTiled;
+
+/* Keep the particles of each grid in Morton order of their zones,
+   re-sorted after every particle push (Grid_SortParticlesByCell.C). */
+
+EXTERN int ParticleSortByCell;
+
 /* Dual energy formalism (TRUE or FALSE). */
 
 EXTERN int DualEnergyFormalism;
@@ -359,6 +387,12 @@ EXTERN CoolDataType CoolData;
 EXTERN int RadiativeCoolingModel;
 EXTERN int use_grackle;
 
+/* Solve the grackle chemistry of a whole level in batches of
+   GrackleBatchSize cells (see GrackleSolveLevel.C). */
+
+EXTERN int GrackleLevelBatch;
+EXTERN int GrackleBatchSize;
+
 /* Cloudy cooling parameters and data. */
 
 EXTERN CloudyCoolingDataType CloudyCoolingData;
@@ -564,6 +598,13 @@ EXTERN int StaticPartitionNestedGrids;
 EXTERN int ExtractFieldsOnly;
 EXTERN int First_Pass;
 EXTERN int UnigridTranspose;
+EXTERN int FFTPencilDecomposition;
+EXTERN int AggregateGhostZoneExchange;
+EXTERN int DistributedHierarchy;
+
+/* Allocate the baryon fields of a grid in one aligned slab. */
+
+EXTERN int UseBaryonFieldSlab;
 EXTERN int NumberOfRootGridTilesPerDimensionPerProcessor;
 EXTERN int CosmologySimulationNumberOfInitialGrids;
 EXTERN int UserDefinedRootGridLayout[3];
@@ -742,6 +783,17 @@ EXTERN FLOAT TracerParticleCreationRightEdge[MAX_DIMENSION];
 EXTERN int   ParticleTypeInFile;
 EXTERN int   OutputParticleTypeGrouping;
 
+/* Asynchronous output: the grid data of a dump is staged in memory and
+   written by a background thread (budget in MB per process). */
+
+EXTERN int   AsynchronousOutput;
+EXTERN int   AsynchronousOutputMemoryLimit;
+
+/* Write the grid data of a dump to this many aggregated files instead
+   of one file per process (0: off). */
+
+EXTERN int   OutputAggregateFiles;
+
 EXTERN int   ExternalBoundaryIO;
 EXTERN int   ExternalBoundaryTypeIO;
 EXTERN int   ExternalBoundaryValueIO;
@@ -845,6 +897,8 @@ EXTERN int NEQ_MHD;
 EXTERN int ReconstructionMethod;
 EXTERN int PositiveReconstruction;
 EXTERN int RiemannSolverFallback;
+EXTERN int RiemannSolverBatch;
+EXTERN int PPMPencilBlockSize;
 EXTERN int RiemannSolver;
 EXTERN int ConservativeReconstruction;
 EXTERN int EOSType;
@@ -951,6 +1005,11 @@ EXTERN char *MetalCoolingTable;
 EXTERN int CIECooling;
 EXTERN int H2OpticalDepthApproximation;
 
+/* Solve the rate and cooling equations in batches of this many cells
+   (0 - whole grid at once). */
+
+EXTERN int RateCoolBatchSize;
+
 //   1 - Adaptive ray tracing transfer
 //   0 - none
 EXTERN int RadiativeTransfer;
@@ -1179,6 +1238,9 @@ EXTERN float SmartStarSMSLifetime;
 /* For EnzoTiming Behavior */
 EXTERN int TimingCycleSkip; // Frequency of timing data dumps.
 
+/* OpenMP threading of the grid loops in EvolveLevel (openmp-yes only) */
+EXTERN int ThreadedGridLoops;
+
 /* For the galaxy simulation boundary method */
 EXTERN int GalaxySimulationRPSWind;
 /* GalaxySimulationRPSWind
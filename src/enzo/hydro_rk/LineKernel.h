@@ -0,0 +1,32 @@
+/***********************************************************************
+/
+/  SPECIALIZED 1D HYDRO/MHD LINE SOLVERS
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: A line kernel reconstructs one line of primitives and
+/    solves its Riemann problems (and the species/colour fluxes) with
+/    the reconstruction, Riemann solver, EOS and dual energy setting
+/    fixed at compile time.  The kernels are instantiated in
+/    RiemannBatch.C for the combinations listed in LineKernelList.def.
+/
+/    FindLineKernel() returns the kernel matching the current
+/    ReconstructionMethod, RiemannSolver, EOSType and
+/    DualEnergyFormalism, or NULL when there is none (or when
+/    RiemannSolverBatch is off), in which case the sweeps call the
+/    generic HydroLine/MHDLine.
+/
+************************************************************************/
+
+#ifndef LINE_KERNEL_DEFINED__
+#define LINE_KERNEL_DEFINED__
+
+typedef int (*LineKernel)(float **Prim, float **priml, float **primr,
+			  float **species, float **colors, float **FluxLine,
+			  int ActiveSize, char direc);
+
+LineKernel FindLineKernel(int mhd);
+
+#endif
@@ -0,0 +1,218 @@
+/***********************************************************************
+/
+/  TEMPLATED PLM/PPM RECONSTRUCTION KERNELS
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: The bodies of plm (Rec_PLM.C) and ppm (Rec_PPM.C), templated
+/    on the number of reconstructed primitives.  With NPRIM > 0 the
+/    field loop has a compile-time trip count and the kernel can be
+/    inlined into the specialized line solvers (RiemannBatch.C); with
+/    NPRIM = 0 the run-time Neq is used, which is what plm() and ppm()
+/    call.  The run-time parameters (Theta_Limiter, Gamma, ...) are
+/    read once per call, outside of the loops.
+/
+/    Requires ReconstructionRoutines.h (Min, minmod) to be included
+/    first.
+/
+************************************************************************/
+
+#ifndef RECONSTRUCTION_KERNELS_DEFINED__
+#define RECONSTRUCTION_KERNELS_DEFINED__
+
+#ifdef USE_OPENMP
+#define RECONSTRUCTION_SIMD _Pragma("omp simd")
+#else
+#define RECONSTRUCTION_SIMD
+#endif
+
+/* Limited slope extrapolation to the interface, as plm_point */
+
+inline float plm_limited(float vm1, float v, float vp1, float theta)
+{
+  float dv_l = (v-vm1) * theta;
+  float dv_r = (vp1-v) * theta;
+  float dv_m = 0.5*(vp1-vm1);
+  return v + 0.5*minmod(dv_l, dv_r, dv_m);
+}
+
+/************************************************************************
+   PLM: priml/primr[field][0..ActiveSize] from prim[field][...]
+************************************************************************/
+
+template <int NPRIM>
+void plm_kernel(float **prim, float **priml, float **primr, int ActiveSize,
+		int Neq)
+{
+
+  const int neq = (NPRIM > 0) ? NPRIM : Neq;
+  const int offset = NumberOfGhostZones - 1;
+  const float theta = Theta_Limiter, rho_floor = SmallRho;
+
+  for (int field = 0; field < neq; field++) {
+    const float *p = prim[field] + offset;
+    float *pl = priml[field], *pr = primr[field];
+    RECONSTRUCTION_SIMD
+    for (int i = 0; i < ActiveSize+1; i++) {
+      pl[i] = plm_limited(p[i-1], p[i  ], p[i+1], theta);
+      pr[i] = plm_limited(p[i+2], p[i+1], p[i  ], theta);
+    }
+  }
+
+  float *dl = priml[0], *dr = primr[0];
+  for (int i = 0; i < ActiveSize+1; i++) {
+    dl[i] = max(dl[i], rho_floor);
+    dr[i] = max(dr[i], rho_floor);
+  }
+
+}
+
+/************************************************************************
+   PPM: fourth-order interface values followed by contact steepening,
+   shock flattening and monotonization (Colella & Woodward 1984, Marti
+   & Muller 1996).  As in ppm, the output has one extra interface on
+   the left (p0l,r[field][0..ActiveSize+1]).
+************************************************************************/
+
+template <int NPRIM>
+void ppm_quartic_kernel(float **prim, float **p0l, float **p0r, int ActiveSize,
+			int Neq)
+{
+
+  const int neq = (NPRIM > 0) ? NPRIM : Neq;
+
+  for (int field = 0; field < neq; field++) {
+    const float *p = prim[field] + 1;
+    float *pl = p0l[field], *pr = p0r[field];
+    RECONSTRUCTION_SIMD
+    for (int i = 0; i < ActiveSize+2; i++) {
+
+      float ap2 = p[i+2], ap1 = p[i+1], a = p[i], am1 = p[i-1];
+
+      // compute da_j+1
+      float ap2ma = ap2 - a, ap1ma = ap1 - a, ap2map1 = ap2 - ap1;
+      float dap1 = (ap2map1*ap1ma > 0) ?
+	sign(ap2ma)*Min(0.5*fabs(ap2ma), 2.0*fabs(ap1ma), 2.0*fabs(ap2map1)) : 0.0;
+
+      // compute da_j
+      float ap1mam1 = ap1 - am1, amam1 = a - am1;
+      float da = (ap1ma*amam1 > 0) ?
+	sign(ap1mam1)*Min(0.5*fabs(ap1mam1), 2.0*fabs(amam1), 2.0*fabs(ap1ma)) : 0.0;
+
+      pl[i] = a + 0.5*ap1ma - dap1/6.0 + da/6.0;
+      pr[i] = pl[i];
+    }
+  }
+
+}
+
+template <int NPRIM>
+void ppm_dissipation_kernel(float **prim, float **p0l, float **p0r,
+			    int ActiveSize, int Neq)
+{
+
+  const int neq = (NPRIM > 0) ? NPRIM : Neq;
+  const float K0 = 1.0, eta1 = 5.0, eta2 = 0.05, eps1 = 0.1, eps2 = 1.0,
+    w1 = 0.52, w2 = 10.0;
+  const float gam = Gamma;
+  const int ipres = 1;
+  const float *den = prim[iden], *pres = prim[ipres], *vel = prim[ivx];
+
+  for (int i = 0; i < ActiveSize+1; i++) {
+
+    int iprim = i + 2;
+    float rho_p1 = den[iprim+1], rho_m1 = den[iprim-1];
+    float p = pres[iprim], p_p1 = pres[iprim+1], p_p2 = pres[iprim+2],
+      p_m1 = pres[iprim-1], p_m2 = pres[iprim-2];
+    float v_p1 = vel[iprim+1], v_m1 = vel[iprim-1];
+
+    /* The switches only depend on the position along the line */
+
+    int contact = (gam*K0*fabs(rho_p1-rho_m1)/min(rho_p1,rho_m1) >=
+		   fabs(p_p1-p_m1)/min(p_p1, p_m1));
+    int shock = (i >= 1 && i <= ActiveSize) &&
+      (fabs(p_p1-p_m1)/min(p_p1,p_m1) > eps2 && v_m1 > v_p1);
+    float f = 0.0;
+    if (shock) {
+      float f0 = min(1.0, max(0.0, ((p_p1-p_m1)/(p_p2-p_m2) - w1)*w2));
+      if (p_p1 - p_m1 > 0) {
+	float p_p3 = pres[iprim+3];
+	float f0p1 = min(1.0, max(0.0, ((p_p2-p)/(p_p3-p_m1) - w1)*w2));
+	f = max(f0, f0p1);
+      } else {
+	float p_m3 = pres[iprim-3];
+	float f0m1 = min(1.0, max(0.0, ((p-p_m2)/(p_p1-p_m3) - w1)*w2));
+	f = max(f0, f0m1);
+      }
+    }
+
+    for (int field = 0; field < neq; field++) {
+
+      const float *q = prim[field];
+      float ap2 = q[iprim+2], ap1 = q[iprim+1], a = q[iprim],
+	am1 = q[iprim-1], am2 = q[iprim-2];
+      float ar = p0l[field][i+1], al = p0r[field][i];
+
+      // 1) Contact steepening
+      if (contact) {
+
+	float ap2ma = ap2 - a, ap1ma = ap1 - a, ap2map1 = ap2 - ap1;
+	float dap1 = (ap2map1*ap1ma > 0) ?
+	  sign(ap2ma)*Min(0.5*fabs(ap2ma), 2.0*fabs(ap1ma), 2.0*fabs(ap2map1)) : 0.0;
+
+	float amam2 = a - am2, am1mam2 = am1 - am2, amam1 = a - am1;
+	float dam1 = (amam1*am1mam2 > 0) ?
+	  sign(amam2)*Min(0.5*fabs(amam2), 2.0*fabs(am1mam2), 2.0*fabs(amam1)) : 0.0;
+
+	float adl = ap1 - 0.5*dap1;
+	float adr = am1 + 0.5*dam1;
+
+	float d2a = ap1 - 2.0*a + am1;
+	float d2ap1 = ap2 - 2.0*ap1 + a;
+	float d2am1 = a - 2.0*am1 + am2;
+	float ap1mam1 = ap1 - am1;
+	float eta0 = (-d2ap1*d2am1 > 0 &&
+		      fabs(ap1mam1) - eps1*min(fabs(ap1),fabs(am1)) > 0) ?
+	  -(d2a-d2am1)/(6.0*ap1mam1) : 0.0;
+	float eta = max(0.0, min(eta1*(eta0-eta2), 1.0));
+
+	ar = ar*(1.0-eta) + adl*eta;
+	al = al*(1.0-eta) + adr*eta;
+      }
+
+      // 2) Shock flattening
+      if (shock) {
+	ar = a*f + ar*(1.0-f);
+	al = a*f + al*(1.0-f);
+      }
+
+      // 3) Monotonization
+      float rr = ar, ll = al;
+      if ((ar-a)*(a-al) <= 0) {
+	rr = a;
+	ll = a;
+      }
+      if ((ar-al)*(a-0.5*(ar+al)) > (ar-al)*(ar-al)/6.0)
+	ll = 3.0*a - 2.0*ar;
+      if (-(ar-al)*(a-0.5*(ar+al)) > (ar-al)*(ar-al)/6.0)
+	rr = 3.0*a - 2.0*al;
+
+      p0l[field][i+1] = rr;
+      p0r[field][i] = ll;
+
+    }
+  }
+
+}
+
+template <int NPRIM>
+void ppm_kernel(float **prim, float **priml, float **primr, int ActiveSize,
+		int Neq)
+{
+  ppm_quartic_kernel<NPRIM>(prim, priml, primr, ActiveSize, Neq);
+  ppm_dissipation_kernel<NPRIM>(prim, priml, primr, ActiveSize, Neq);
+}
+
+#endif
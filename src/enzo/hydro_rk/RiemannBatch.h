@@ -0,0 +1,501 @@
+/***********************************************************************
+/
+/  BATCHED (STRUCTURE-OF-ARRAYS) RIEMANN SOLVERS
+/
+/  written by: Enzo development team
+/  date:       October, 2026
+/  modified1:
+/
+/  PURPOSE: Branch-free versions of hll, hllc, hll_mhd and hlld_mhd
+/    that solve all ActiveSize+1 interfaces of a line in one loop
+/    without function calls, so that the compiler can vectorize across
+/    interfaces.  The interface states are read directly from the
+/    priml/primr field arrays (rho, eint, vx, vy, vz[, Bx, By, Bz, Phi])
+/    and the fluxes are written to FluxLine[field][n].
+/
+/    The kernels are templated on the number of conserved equations
+/    (NEQ_HYDRO = 5/6, NEQ_MHD = 9/10), so that the flux layout (iEint,
+/    iBx, ..., iPhi) and the dual energy terms are fixed at compile
+/    time, and on the equation of state (RiemannEOSIdeal for EOSType =
+/    0, RiemannEOSIsothermal for EOSType = 3).  The EOS classes follow
+/    EOS() in EOS.h, including the reset of the specific internal
+/    energy by the isothermal EOS.
+/
+************************************************************************/
+
+#ifndef RIEMANN_BATCH_DEFINED__
+#define RIEMANN_BATCH_DEFINED__
+
+#ifdef USE_OPENMP
+#define RIEMANN_BATCH_SIMD _Pragma("omp simd")
+#else
+#define RIEMANN_BATCH_SIMD
+#endif
+
+/* Compile-time layout of the conserved fields (see ReadParameterFile
+   for the run-time equivalents iEint, iBx, ...). */
+
+template <int NEQ, bool MHD>
+struct RiemannBatchLayout {
+  enum {
+    Dual = MHD ? (NEQ == 10) : (NEQ == 6),
+    D = 0, S1 = 1, S2 = 2, S3 = 3, Etot = 4, Eint = 5,
+    Bx = Dual ? 6 : 5, By = Bx+1, Bz = Bx+2, Phi = Bx+3
+  };
+};
+
+/* Equations of state.  Energy() is mode 2 of EOS() (given rho and e)
+   and Pressure() is mode 1 (given p and rho); both may overwrite e
+   and p as EOS() does.  The run-time constants are copied when the
+   object is made, before the loop over interfaces. */
+
+struct RiemannEOSIdeal {
+  enum { Type = 0 };
+  float gam, gm1;
+  RiemannEOSIdeal(void) : gam(Gamma), gm1(Gamma - 1) {}
+  inline void Energy(float rho, float &e, float &p, float &h, float &cs) const
+  {
+    p = gm1 * rho * e;
+    float poverrho = p / rho;
+    h = e + poverrho;
+    cs = sqrt(gam*poverrho);
+  }
+  inline void Pressure(float rho, float &p, float &e, float &h, float &cs) const
+  {
+    float poverrho = p / rho;
+    e = poverrho / gm1;
+    h = e + poverrho;
+    cs = sqrt(gam*poverrho);
+  }
+};
+
+struct RiemannEOSIsothermal {
+  enum { Type = 3 };
+  float gam, c_s;
+  RiemannEOSIsothermal(void) : gam(Gamma), c_s(EOSSoundSpeed) {}
+  inline void Energy(float rho, float &e, float &p, float &h, float &cs) const
+  {
+    cs = c_s;
+    p = rho*cs*cs;
+    e = p / ((gam-1.0)*rho);
+    h = e + p/rho;
+  }
+  inline void Pressure(float rho, float &p, float &e, float &h, float &cs) const
+  {
+    Energy(rho, e, p, h, cs);
+  }
+};
+
+/************************************************************************
+   HLL (hydro)
+************************************************************************/
+
+template <int NEQ, class EOS>
+void hll_batch(float **FluxLine, float **priml, float **primr, int ActiveSize)
+{
+
+  typedef RiemannBatchLayout<NEQ, false> L;
+
+  const float *dl = priml[0], *el = priml[1], *ul = priml[2], *vl = priml[3],
+    *wl = priml[4];
+  const float *dr = primr[0], *er = primr[1], *ur = primr[2], *vr = primr[3],
+    *wr = primr[4];
+  float *FD = FluxLine[L::D], *FS1 = FluxLine[L::S1], *FS2 = FluxLine[L::S2],
+    *FS3 = FluxLine[L::S3], *FE = FluxLine[L::Etot];
+  float *FEint = (L::Dual) ? FluxLine[L::Eint] : FluxLine[L::Etot];
+  const EOS eos;
+
+  RIEMANN_BATCH_SIMD
+  for (int n = 0; n < ActiveSize+1; n++) {
+
+    float rho_l = dl[n], eint_l = el[n], vx_l = ul[n], vy_l = vl[n], vz_l = wl[n];
+    float rho_r = dr[n], eint_r = er[n], vx_r = ur[n], vy_r = vr[n], vz_r = wr[n];
+
+    float v2_l = vx_l*vx_l + vy_l*vy_l + vz_l*vz_l;
+    float v2_r = vx_r*vx_r + vy_r*vy_r + vz_r*vz_r;
+    float etot_l = eint_l + 0.5*v2_l, etot_r = eint_r + 0.5*v2_r;
+    float p_l, p_r, h_l, h_r, cs_l, cs_r;
+    eos.Energy(rho_l, eint_l, p_l, h_l, cs_l);
+    eos.Energy(rho_r, eint_r, p_r, h_r, cs_r);
+    if (EOS::Type > 0) {
+      p_l = el[n];
+      p_r = er[n];
+      cs_l = sqrt(p_l/rho_l);
+      cs_r = sqrt(p_r/rho_r);
+    }
+
+    float ap = max(max(0.0f, vx_l + cs_l), vx_r + cs_r);
+    float am = max(max(0.0f, -(vx_l - cs_l)), -(vx_r - cs_r));
+    float apam = ap*am, norm = ap + am;
+
+#define HLL_BATCH_FLUX(Fl, Fr, Ul, Ur) ((ap*(Fl) + am*(Fr) - apam*((Ur) - (Ul)))/norm)
+
+    FD[n]  = HLL_BATCH_FLUX(rho_l*vx_l, rho_r*vx_r, rho_l, rho_r);
+    FS1[n] = HLL_BATCH_FLUX(rho_l*vx_l*vx_l + p_l, rho_r*vx_r*vx_r + p_r,
+			    rho_l*vx_l, rho_r*vx_r);
+    FS2[n] = HLL_BATCH_FLUX(rho_l*vy_l*vx_l, rho_r*vy_r*vx_r,
+			    rho_l*vy_l, rho_r*vy_r);
+    FS3[n] = HLL_BATCH_FLUX(rho_l*vz_l*vx_l, rho_r*vz_r*vx_r,
+			    rho_l*vz_l, rho_r*vz_r);
+    FE[n]  = HLL_BATCH_FLUX(rho_l*(0.5*v2_l + h_l)*vx_l,
+			    rho_r*(0.5*v2_r + h_r)*vx_r,
+			    rho_l*etot_l, rho_r*etot_r);
+    if (L::Dual)
+      FEint[n] = HLL_BATCH_FLUX(rho_l*eint_l*vx_l, rho_r*eint_r*vx_r,
+				rho_l*eint_l, rho_r*eint_r);
+
+#undef HLL_BATCH_FLUX
+
+  }
+
+}
+
+/************************************************************************
+   HLLC (hydro)
+
+   The side of the contact is chosen first, so only one star state
+   is computed per interface.
+************************************************************************/
+
+template <int NEQ, class EOS>
+void hllc_batch(float **FluxLine, float **priml, float **primr, int ActiveSize)
+{
+
+  typedef RiemannBatchLayout<NEQ, false> L;
+
+  const float *dl = priml[0], *el = priml[1], *ul = priml[2], *vl = priml[3],
+    *wl = priml[4];
+  const float *dr = primr[0], *er = primr[1], *ur = primr[2], *vr = primr[3],
+    *wr = primr[4];
+  float *FD = FluxLine[L::D], *FS1 = FluxLine[L::S1], *FS2 = FluxLine[L::S2],
+    *FS3 = FluxLine[L::S3], *FE = FluxLine[L::Etot];
+  float *FEint = (L::Dual) ? FluxLine[L::Eint] : FluxLine[L::Etot];
+  const EOS eos;
+
+  RIEMANN_BATCH_SIMD
+  for (int n = 0; n < ActiveSize+1; n++) {
+
+    float rho_l = dl[n], eint_l = el[n], vx_l = ul[n], vy_l = vl[n], vz_l = wl[n];
+    float rho_r = dr[n], eint_r = er[n], vx_r = ur[n], vy_r = vr[n], vz_r = wr[n];
+
+    float p_l, p_r, h_l, h_r, cs_l, cs_r;
+    eos.Energy(rho_l, eint_l, p_l, h_l, cs_l);
+    eos.Energy(rho_r, eint_r, p_r, h_r, cs_r);
+
+    float lam_l = min(vx_l - cs_l, vx_r - cs_r);
+    float lam_r = max(vx_l + cs_l, vx_r + cs_r);
+    float lam_c = (rho_r*vx_r*(lam_r-vx_r) - rho_l*vx_l*(lam_l-vx_l) + p_l - p_r)/
+      (rho_r*(lam_r-vx_r) - rho_l*(lam_l-vx_l));
+
+    /* Upwind state: left of the left wave or of the contact uses the
+       left state, otherwise the right state. */
+
+    int left = (lam_l >= 0) || (!(lam_r <= 0) && lam_c >= 0);
+    int star = !(lam_l >= 0) && !(lam_r <= 0);
+
+    float rho_k  = left ? rho_l  : rho_r;
+    float eint_k = left ? eint_l : eint_r;
+    float vx_k   = left ? vx_l   : vx_r;
+    float vy_k   = left ? vy_l   : vy_r;
+    float vz_k   = left ? vz_l   : vz_r;
+    float p_k    = left ? p_l    : p_r;
+    float h_k    = left ? h_l    : h_r;
+    float lam_k  = left ? lam_l  : lam_r;
+
+    /* star state (mode 1 of the EOS: given p and rho) */
+
+    float frac  = (lam_k-vx_k)/(lam_k-lam_c);
+    float rho_c = rho_k*frac;
+    float p_c   = p_k + rho_k*(vx_k-lam_k)*(vx_k-lam_c);
+    float vy_c  = vy_k*rho_k/rho_c*frac;
+    float vz_c  = vz_k*rho_k/rho_c*frac;
+    float eint_c, h_c, cs_c;
+    eos.Pressure(rho_c, p_c, eint_c, h_c, cs_c);
+
+    float rho_f  = star ? rho_c  : rho_k;
+    float vx_f   = star ? lam_c  : vx_k;
+    float vy_f   = star ? vy_c   : vy_k;
+    float vz_f   = star ? vz_c   : vz_k;
+    float p_f    = star ? p_c    : p_k;
+    float eint_f = star ? eint_c : eint_k;
+    float h_f    = star ? h_c    : h_k;
+    float v2_f   = vx_f*vx_f + vy_f*vy_f + vz_f*vz_f;
+
+    FD[n]  = rho_f * vx_f;
+    FS1[n] = rho_f * vx_f * vx_f + p_f;
+    FS2[n] = rho_f * vy_f * vx_f;
+    FS3[n] = rho_f * vz_f * vx_f;
+    FE[n]  = rho_f * (0.5*v2_f + h_f) * vx_f;
+    if (L::Dual)
+      FEint[n] = rho_f * eint_f * vx_f;
+
+  }
+
+}
+
+/************************************************************************
+   HLL (MHD with Dedner divergence cleaning)
+************************************************************************/
+
+template <int NEQ, class EOS>
+void hll_mhd_batch(float **FluxLine, float **priml, float **primr, int ActiveSize)
+{
+
+  typedef RiemannBatchLayout<NEQ, true> L;
+
+  const float *dl = priml[0], *el = priml[1], *ul = priml[2], *vl = priml[3],
+    *wl = priml[4], *bxl = priml[5], *byl = priml[6], *bzl = priml[7],
+    *phl = priml[8];
+  const float *dr = primr[0], *er = primr[1], *ur = primr[2], *vr = primr[3],
+    *wr = primr[4], *bxr = primr[5], *byr = primr[6], *bzr = primr[7],
+    *phr = primr[8];
+  float *FD = FluxLine[L::D], *FS1 = FluxLine[L::S1], *FS2 = FluxLine[L::S2],
+    *FS3 = FluxLine[L::S3], *FE = FluxLine[L::Etot], *FBx = FluxLine[L::Bx],
+    *FBy = FluxLine[L::By], *FBz = FluxLine[L::Bz], *FPhi = FluxLine[L::Phi];
+  float *FEint = (L::Dual) ? FluxLine[L::Eint] : FluxLine[L::Etot];
+  const EOS eos;
+  const float ch = C_h;
+
+  RIEMANN_BATCH_SIMD
+  for (int n = 0; n < ActiveSize+1; n++) {
+
+    float rho_l = dl[n], eint_l = el[n], vx_l = ul[n], vy_l = vl[n], vz_l = wl[n];
+    float Bx_l = bxl[n], By_l = byl[n], Bz_l = bzl[n], Phi_l = phl[n];
+    float rho_r = dr[n], eint_r = er[n], vx_r = ur[n], vy_r = vr[n], vz_r = wr[n];
+    float Bx_r = bxr[n], By_r = byr[n], Bz_r = bzr[n], Phi_r = phr[n];
+
+    float B2_l = Bx_l*Bx_l + By_l*By_l + Bz_l*Bz_l;
+    float B2_r = Bx_r*Bx_r + By_r*By_r + Bz_r*Bz_r;
+    float Bv_l = Bx_l*vx_l + By_l*vy_l + Bz_l*vz_l;
+    float Bv_r = Bx_r*vx_r + By_r*vy_r + Bz_r*vz_r;
+    float v2_l = vx_l*vx_l + vy_l*vy_l + vz_l*vz_l;
+    float v2_r = vx_r*vx_r + vy_r*vy_r + vz_r*vz_r;
+    float etot_l = eint_l + 0.5*v2_l + 0.5*B2_l/rho_l;
+    float etot_r = eint_r + 0.5*v2_r + 0.5*B2_r/rho_r;
+    float p_l, p_r, h_l, h_r, cs_l, cs_r;
+    eos.Energy(rho_l, eint_l, p_l, h_l, cs_l);
+    eos.Energy(rho_r, eint_r, p_r, h_r, cs_r);
+    if (EOS::Type > 0) {
+      p_l = el[n];
+      p_r = er[n];
+      cs_l = sqrt(p_l/rho_l);
+      cs_r = sqrt(p_r/rho_r);
+    }
+    float cs2_l = cs_l*cs_l, cs2_r = cs_r*cs_r;
+
+    /* fast magnetosonic speeds */
+
+    float t_l = cs2_l + B2_l/rho_l, t_r = cs2_r + B2_r/rho_r;
+    float cf_l = sqrt(0.5*(t_l + sqrt(fabs(t_l*t_l - 4.0*cs2_l*(Bx_l*Bx_l/rho_l)))));
+    float cf_r = sqrt(0.5*(t_r + sqrt(fabs(t_r*t_r - 4.0*cs2_r*(Bx_r*Bx_r/rho_r)))));
+
+    float ap = max(max(0.0f, vx_l + cf_l), vx_r + cf_r);
+    float am = max(max(0.0f, -(vx_l - cf_l)), -(vx_r - cf_r));
+    float apam = ap*am, norm = ap + am;
+
+#define HLL_BATCH_FLUX(Fl, Fr, Ul, Ur) ((ap*(Fl) + am*(Fr) - apam*((Ur) - (Ul)))/norm)
+
+    FD[n]  = HLL_BATCH_FLUX(rho_l*vx_l, rho_r*vx_r, rho_l, rho_r);
+    FS1[n] = HLL_BATCH_FLUX(rho_l*vx_l*vx_l + p_l + 0.5*B2_l - Bx_l*Bx_l,
+			    rho_r*vx_r*vx_r + p_r + 0.5*B2_r - Bx_r*Bx_r,
+			    rho_l*vx_l, rho_r*vx_r);
+    FS2[n] = HLL_BATCH_FLUX(rho_l*vy_l*vx_l - Bx_l*By_l,
+			    rho_r*vy_r*vx_r - Bx_r*By_r,
+			    rho_l*vy_l, rho_r*vy_r);
+    FS3[n] = HLL_BATCH_FLUX(rho_l*vz_l*vx_l - Bx_l*Bz_l,
+			    rho_r*vz_r*vx_r - Bx_r*Bz_r,
+			    rho_l*vz_l, rho_r*vz_r);
+    FE[n]  = HLL_BATCH_FLUX(rho_l*(0.5*v2_l + h_l)*vx_l + B2_l*vx_l - Bx_l*Bv_l,
+			    rho_r*(0.5*v2_r + h_r)*vx_r + B2_r*vx_r - Bx_r*Bv_r,
+			    rho_l*etot_l, rho_r*etot_r);
+    if (L::Dual)
+      FEint[n] = HLL_BATCH_FLUX(rho_l*eint_l*vx_l, rho_r*eint_r*vx_r,
+				rho_l*eint_l, rho_r*eint_r);
+    FBy[n] = HLL_BATCH_FLUX(vx_l*By_l - vy_l*Bx_l, vx_r*By_r - vy_r*Bx_r,
+			    By_l, By_r);
+    FBz[n] = HLL_BATCH_FLUX(-vz_l*Bx_l + vx_l*Bz_l, -vz_r*Bx_r + vx_r*Bz_r,
+			    Bz_l, Bz_r);
+
+    /* Dedner cleaning: Bx and Phi */
+
+    FBx[n] = HLL_BATCH_FLUX(0.0f, 0.0f, Bx_l, Bx_r) +
+      Phi_l + 0.5*(Phi_r-Phi_l) - 0.5*ch*(Bx_r-Bx_l);
+    FPhi[n] = (Bx_l + 0.5*(Bx_r-Bx_l) - 0.5/ch*(Phi_r-Phi_l)) * (ch*ch);
+
+#undef HLL_BATCH_FLUX
+
+  }
+
+}
+
+/************************************************************************
+   HLLD (MHD with Dedner divergence cleaning, Miyoshi & Kusano 2005)
+
+   All four intermediate states are evaluated and the flux is picked
+   by the wave speeds, in the same order as hlld_mhd.  The star states
+   carry the specific internal energy of their side for the dual
+   energy flux.
+************************************************************************/
+
+template <int NEQ, class EOS>
+void hlld_mhd_batch(float **FluxLine, float **priml, float **primr, int ActiveSize)
+{
+
+  typedef RiemannBatchLayout<NEQ, true> L;
+
+  const float *dl = priml[0], *el = priml[1], *ul = priml[2], *vl = priml[3],
+    *wl = priml[4], *bxl = priml[5], *byl = priml[6], *bzl = priml[7],
+    *phl = priml[8];
+  const float *dr = primr[0], *er = primr[1], *ur = primr[2], *vr = primr[3],
+    *wr = primr[4], *bxr = primr[5], *byr = primr[6], *bzr = primr[7],
+    *phr = primr[8];
+  float *FD = FluxLine[L::D], *FS1 = FluxLine[L::S1], *FS2 = FluxLine[L::S2],
+    *FS3 = FluxLine[L::S3], *FE = FluxLine[L::Etot], *FBx = FluxLine[L::Bx],
+    *FBy = FluxLine[L::By], *FBz = FluxLine[L::Bz], *FPhi = FluxLine[L::Phi];
+  float *FEint = (L::Dual) ? FluxLine[L::Eint] : FluxLine[L::Etot];
+  const EOS eos;
+  const float gam = Gamma, ch = C_h;
+  const float eps = BFLOAT_EPSILON;
+
+  RIEMANN_BATCH_SIMD
+  for (int n = 0; n < ActiveSize+1; n++) {
+
+    float rho_l = dl[n], eint_l = el[n], vx_l = ul[n], vy_l = vl[n], vz_l = wl[n];
+    float Bx_l = bxl[n], By_l = byl[n], Bz_l = bzl[n], Phi_l = phl[n];
+    float rho_r = dr[n], eint_r = er[n], vx_r = ur[n], vy_r = vr[n], vz_r = wr[n];
+    float Bx_r = bxr[n], By_r = byr[n], Bz_r = bzr[n], Phi_r = phr[n];
+
+    /* left and right states and fluxes */
+
+    float B2_l = Bx_l*Bx_l + By_l*By_l + Bz_l*Bz_l;
+    float B2_r = Bx_r*Bx_r + By_r*By_r + Bz_r*Bz_r;
+    float Bv_l = Bx_l*vx_l + By_l*vy_l + Bz_l*vz_l;
+    float Bv_r = Bx_r*vx_r + By_r*vy_r + Bz_r*vz_r;
+    float etot_l = rho_l*(eint_l + 0.5*(vx_l*vx_l + vy_l*vy_l + vz_l*vz_l)) + 0.5*B2_l;
+    float etot_r = rho_r*(eint_r + 0.5*(vx_r*vx_r + vy_r*vy_r + vz_r*vz_r)) + 0.5*B2_r;
+    float p_l, p_r, h_l, h_r, cs_l, cs_r;
+    eos.Energy(rho_l, eint_l, p_l, h_l, cs_l);
+    eos.Energy(rho_r, eint_r, p_r, h_r, cs_r);
+    float pt_l = p_l + 0.5*B2_l, pt_r = p_r + 0.5*B2_r;
+    float gp_l = gam*p_l + B2_l, gp_r = gam*p_r + B2_r;
+    float cf_l = sqrt((gp_l + sqrt(gp_l*gp_l - 4.*gam*p_l*Bx_l*Bx_l))/(2.*rho_l));
+    float cf_r = sqrt((gp_r + sqrt(gp_r*gp_r - 4.*gam*p_r*Bx_r*Bx_r))/(2.*rho_r));
+
+    float UD_l = rho_l, US1_l = rho_l*vx_l, US2_l = rho_l*vy_l, US3_l = rho_l*vz_l,
+      UEi_l = rho_l*eint_l;
+    float UD_r = rho_r, US1_r = rho_r*vx_r, US2_r = rho_r*vy_r, US3_r = rho_r*vz_r,
+      UEi_r = rho_r*eint_r;
+
+    float FD_l = rho_l*vx_l, FS1_l = US1_l*vx_l + pt_l - Bx_l*Bx_l,
+      FS2_l = US2_l*vx_l - Bx_l*By_l, FS3_l = US3_l*vx_l - Bx_l*Bz_l,
+      FE_l = (etot_l + pt_l)*vx_l - Bx_l*Bv_l, FEi_l = UEi_l*vx_l,
+      FBy_l = vx_l*By_l - vy_l*Bx_l, FBz_l = -vz_l*Bx_l + vx_l*Bz_l;
+    float FD_r = rho_r*vx_r, FS1_r = US1_r*vx_r + pt_r - Bx_r*Bx_r,
+      FS2_r = US2_r*vx_r - Bx_r*By_r, FS3_r = US3_r*vx_r - Bx_r*Bz_r,
+      FE_r = (etot_r + pt_r)*vx_r - Bx_r*Bv_r, FEi_r = UEi_r*vx_r,
+      FBy_r = vx_r*By_r - vy_r*Bx_r, FBz_r = -vz_r*Bx_r + vx_r*Bz_r;
+
+    /* wave speeds */
+
+    float Bx = 0.5*(Bx_l + Bx_r);
+    float S_l = min(vx_l, vx_r) - max(cf_l, cf_r);
+    float S_r = max(vx_l, vx_r) + max(cf_l, cf_r);
+    float dS_l = S_l - vx_l, dS_r = S_r - vx_r;
+    float S_M = (dS_r*rho_r*vx_r - dS_l*rho_l*vx_l - pt_r + pt_l)/
+      (dS_r*rho_r - dS_l*rho_l);
+
+    float rho_ls = rho_l * dS_l/(S_l - S_M);
+    float rho_rs = rho_r * dS_r/(S_r - S_M);
+    float sq_ls = sqrt(rho_ls), sq_rs = sqrt(rho_rs);
+
+    float S_ls = S_M - fabs(Bx)/sq_ls;
+    float S_rs = S_M + fabs(Bx)/sq_rs;
+
+    float pt_s = (dS_r*rho_r*pt_l - dS_l*rho_l*pt_r + rho_l*rho_r*dS_r*dS_l*(vx_r - vx_l))/
+      (dS_r*rho_r - dS_l*rho_l);
+
+    /* single star states (degenerate when the Alfven and fast waves
+       coincide) */
+
+    int degen_l = (fabs(S_M - vx_l) <= eps) && (fabs(By_l) <= eps) &&
+      (fabs(Bz_l) <= eps) && (Bx*Bx >= gam*p_l) &&
+      ((fabs(S_l - (vx_l - cf_l)) <= eps) || (fabs(S_l - (vx_l + cf_l)) <= eps));
+    int degen_r = (fabs(S_M - vx_r) <= eps) && (fabs(By_r) <= eps) &&
+      (fabs(Bz_r) <= eps) && (Bx*Bx >= gam*p_r) &&
+      ((fabs(S_r - (vx_r - cf_r)) <= eps) || (fabs(S_r - (vx_r + cf_r)) <= eps));
+
+    float den_l = rho_l*dS_l*(S_l - S_M) - Bx*Bx;
+    float den_r = rho_r*dS_r*(S_r - S_M) - Bx*Bx;
+    float vv_ls = (S_M - vx_l)/den_l, bb_ls = (rho_l*dS_l*dS_l - Bx*Bx)/den_l;
+    float vv_rs = (S_M - vx_r)/den_r, bb_rs = (rho_r*dS_r*dS_r - Bx*Bx)/den_r;
+
+    float vy_ls = degen_l ? vy_l : vy_l - Bx*By_l*vv_ls;
+    float vz_ls = degen_l ? vz_l : vz_l - Bx*Bz_l*vv_ls;
+    float By_ls = degen_l ? By_l : By_l*bb_ls;
+    float Bz_ls = degen_l ? Bz_l : Bz_l*bb_ls;
+    float vy_rs = degen_r ? vy_r : vy_r - Bx*By_r*vv_rs;
+    float vz_rs = degen_r ? vz_r : vz_r - Bx*Bz_r*vv_rs;
+    float By_rs = degen_r ? By_r : By_r*bb_rs;
+    float Bz_rs = degen_r ? Bz_r : Bz_r*bb_rs;
+
+    float Bv_ls = S_M*Bx + vy_ls*By_ls + vz_ls*Bz_ls;
+    float Bv_rs = S_M*Bx + vy_rs*By_rs + vz_rs*Bz_rs;
+
+    float etot_ls = (dS_l*etot_l - pt_l*vx_l + pt_s*S_M + Bx*(Bv_l - Bv_ls))/(S_l - S_M);
+    float etot_rs = (dS_r*etot_r - pt_r*vx_r + pt_s*S_M + Bx*(Bv_r - Bv_rs))/(S_r - S_M);
+
+    /* double star states */
+
+    float sgn = sign(Bx);
+    float rho_savg = sq_ls + sq_rs;
+    float vy_ss = (sq_ls*vy_ls + sq_rs*vy_rs + (By_rs - By_ls)*sgn)/rho_savg;
+    float vz_ss = (sq_ls*vz_ls + sq_rs*vz_rs + (Bz_rs - Bz_ls)*sgn)/rho_savg;
+    float By_ss = (sq_ls*By_rs + sq_rs*By_ls + sqrt(rho_ls*rho_rs)*(vy_rs - vy_ls)*sgn)/rho_savg;
+    float Bz_ss = (sq_ls*Bz_rs + sq_rs*Bz_ls + sqrt(rho_ls*rho_rs)*(vz_rs - vz_ls)*sgn)/rho_savg;
+    float Bv_ss = S_M*Bx + vy_ss*By_ss + vz_ss*Bz_ss;
+    float etot_lss = etot_ls - sq_ls*(Bv_ls - Bv_ss)*sgn;
+    float etot_rss = etot_rs + sq_rs*(Bv_rs - Bv_ss)*sgn;
+
+    /* Pick the region.  1: F_l, 2: F_r, 3: F_ls, 4: F_rs, 5: F_lss,
+       6: F_rss (checked in this order, as in hlld_mhd). */
+
+    int r1 = (S_l > 0);
+    int r2 = !r1 && (S_r < 0);
+    int r3 = !r1 && !r2 && (S_l <= 0 && S_ls >= 0);
+    int r4 = !r1 && !r2 && !r3 && (S_rs <= 0 && S_r >= 0);
+    int r5 = !r1 && !r2 && !r3 && !r4 && (S_ls <= 0 && S_M >= 0);
+
+#define HLLD_BATCH_FLUX(Fl, Fr, Ul, Ur, Usl, Usr, Ussl, Ussr)		\
+    (r1 ? (Fl) : r2 ? (Fr) :						\
+     r3 ? (Fl) + S_l*((Usl) - (Ul)) :					\
+     r4 ? (Fr) + S_r*((Usr) - (Ur)) :					\
+     r5 ? (Fl) + S_ls*(Ussl) - (S_ls - S_l)*(Usl) - S_l*(Ul) :		\
+     (Fr) + S_rs*(Ussr) - (S_rs - S_r)*(Usr) - S_r*(Ur))
+
+    FD[n]  = HLLD_BATCH_FLUX(FD_l, FD_r, UD_l, UD_r, rho_ls, rho_rs, rho_ls, rho_rs);
+    FS1[n] = HLLD_BATCH_FLUX(FS1_l, FS1_r, US1_l, US1_r, rho_ls*S_M, rho_rs*S_M,
+			     rho_ls*S_M, rho_rs*S_M);
+    FS2[n] = HLLD_BATCH_FLUX(FS2_l, FS2_r, US2_l, US2_r, rho_ls*vy_ls, rho_rs*vy_rs,
+			     rho_ls*vy_ss, rho_rs*vy_ss);
+    FS3[n] = HLLD_BATCH_FLUX(FS3_l, FS3_r, US3_l, US3_r, rho_ls*vz_ls, rho_rs*vz_rs,
+			     rho_ls*vz_ss, rho_rs*vz_ss);
+    FE[n]  = HLLD_BATCH_FLUX(FE_l, FE_r, etot_l, etot_r, etot_ls, etot_rs,
+			     etot_lss, etot_rss);
+    if (L::Dual)
+      FEint[n] = HLLD_BATCH_FLUX(FEi_l, FEi_r, UEi_l, UEi_r, rho_ls*eint_l,
+				 rho_rs*eint_r, rho_ls*eint_l, rho_rs*eint_r);
+    FBy[n] = HLLD_BATCH_FLUX(FBy_l, FBy_r, By_l, By_r, By_ls, By_rs, By_ss, By_ss);
+    FBz[n] = HLLD_BATCH_FLUX(FBz_l, FBz_r, Bz_l, Bz_r, Bz_ls, Bz_rs, Bz_ss, Bz_ss);
+
+#undef HLLD_BATCH_FLUX
+
+    /* Dedner cleaning: Bx and Phi */
+
+    FBx[n]  = Phi_l + 0.5*(Phi_r-Phi_l) - 0.5*ch*(Bx_r-Bx_l);
+    FPhi[n] = (Bx_l + 0.5*(Bx_r-Bx_l) - 0.5/ch*(Phi_r-Phi_l)) * (ch*ch);
+
+  }
+
+}
+
+#endif
@@ -49,6 +49,10 @@
 
 #define MAX_NUMBER_OF_BARYON_FIELDS          __max_baryons  /* must be at least 6 */
 
+/* Byte boundary of the fields in a slab (UseBaryonFieldSlab) */
+
+#define BARYON_FIELD_ALIGNMENT 64
+
 #define MAX_NUMBER_OF_SUBGRIDS               __max_subgrids
 
 #define MAX_DEPTH_OF_HIERARCHY             50
@@ -480,6 +484,10 @@ typedef long long int   HDF5_hid_t;
 #define MPI_SENDPART_TAG 23
 #define MPI_SENDMARKER_TAG 24
 #define MPI_SGMARKER_TAG 25
+#define MPI_GHOSTEXCHANGE_TAG 26
+#define MPI_DISTRIBUTED_HIERARCHY_TAG 27
+#define MPI_SENDSLAB_TAG 28
+#define MPI_SHAREPARTICLES_TAG 29  // and 30
 
 /* The Active Particle tag is this big to ensure that the sends and
    recvs in grid::CommunicationSendActiveParticles match up and that the AP
@@ -0,0 +1,127 @@
+#!/usr/bin/env python
+### ppm_sweep_benchmark.py
+### Description:
+
+### Measures the cell-update rate of the direct-Euler PPM solver
+### (HydroMethod = 0) on the Hydro-3D run tests.  Each problem is run
+### twice from a scratch directory: once sweeping whole slices
+### (PPMPencilBlockSize = -1, the original Grid_SolvePPM_DE behaviour)
+### and once with the cache-blocked sweeps (PPMPencilBlockSize = 0, or
+### the value given with --block).  The number of OpenMP threads is set
+### with --threads (enzo must be built with openmp-yes for it to matter).
+###
+### The cell updates of each cycle are read from the Total lines of
+### performance.out and divided by the time spent in SolveHydroEquations
+### (max over processors), so that I/O and hierarchy rebuilds do not
+### enter the rate.
+###
+### $ python ppm_sweep_benchmark.py --enzo ../enzo/enzo.exe \
+###       --threads 4 --cycles 20 NohProblem3D ShockPool3D
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+default_problems = ["NohProblem3D", "ShockPool3D", "NohProblem3DAMR"]
+
+def read_rate(filename):
+    """
+    Returns (cell updates, hydro seconds, total seconds) summed over all
+    cycles of a performance.out file.
+    """
+    updates = 0.0
+    hydro_time = 0.0
+    total_time = 0.0
+    for line in open(filename):
+        fields = line.split()
+        if len(fields) < 5 or line.startswith("#"):
+            continue
+        if fields[0] == "Total":
+            updates += float(fields[5])
+            total_time += float(fields[4])
+        elif fields[0] == "SolveHydroEquations":
+            hydro_time += float(fields[4])
+    return updates, hydro_time, total_time
+
+def run_problem(args, problem, block):
+    """
+    Runs one problem in a scratch directory with the given
+    PPMPencilBlockSize and returns the rates from performance.out.
+    """
+    source = os.path.join(args.run_dir, problem)
+    parameter_file = os.path.join(source, problem + ".enzo")
+    if not os.path.exists(parameter_file):
+        sys.exit("Cannot find %s" % parameter_file)
+
+    workdir = tempfile.mkdtemp(prefix="ppm_bench_")
+    try:
+        lines = open(parameter_file).readlines()
+        lines = [l for l in lines if not
+                 l.strip().startswith(("StopCycle", "PPMPencilBlockSize",
+                                       "dtDataDump", "CycleSkipDataDump"))]
+        lines.append("StopCycle          = %d\n" % args.cycles)
+        lines.append("PPMPencilBlockSize = %d\n" % block)
+        lines.append("dtDataDump         = 1e30\n")
+        local_file = os.path.join(workdir, problem + ".enzo")
+        open(local_file, "w").writelines(lines)
+
+        env = dict(os.environ)
+        env["OMP_NUM_THREADS"] = str(args.threads)
+        command = args.mpirun.split() + [os.path.abspath(args.enzo), "-d",
+                                         problem + ".enzo"]
+        start = time.time()
+        with open(os.path.join(workdir, "enzo.log"), "w") as log:
+            status = subprocess.call(command, cwd=workdir, env=env,
+                                     stdout=log, stderr=subprocess.STDOUT)
+        wall = time.time() - start
+        if status != 0:
+            sys.exit("%s failed (see %s)" % (problem, workdir))
+
+        updates, hydro_time, total_time = \
+            read_rate(os.path.join(workdir, "performance.out"))
+    finally:
+        if not args.keep:
+            shutil.rmtree(workdir, ignore_errors=True)
+
+    return updates, hydro_time, total_time, wall
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Cell-update rate of the PPM sweeps on Hydro-3D tests")
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser.add_argument("problems", nargs="*", default=default_problems)
+    parser.add_argument("--enzo", default=os.path.join(here, "..", "enzo",
+                                                       "enzo.exe"))
+    parser.add_argument("--run-dir", default=os.path.join(
+        here, "..", "..", "run", "Hydro", "Hydro-3D"))
+    parser.add_argument("--mpirun", default="",
+                        help="launcher prefix, e.g. 'mpirun -np 2'")
+    parser.add_argument("--threads", type=int, default=1)
+    parser.add_argument("--cycles", type=int, default=10)
+    parser.add_argument("--block", type=int, default=0,
+                        help="PPMPencilBlockSize of the tiled run")
+    parser.add_argument("--keep", action="store_true",
+                        help="keep the scratch directories")
+    args = parser.parse_args()
+
+    print("%-20s %-8s %14s %14s %10s" % ("Problem", "Sweep", "Updates/s",
+                                         "Hydro upd/s", "Wall (s)"))
+    for problem in args.problems:
+        rates = []
+        for name, block in (("slice", -1), ("tiled", args.block)):
+            updates, hydro_time, total_time, wall = \
+                run_problem(args, problem, block)
+            rate = updates / max(total_time, 1e-30)
+            hydro_rate = updates / max(hydro_time, 1e-30)
+            rates.append(hydro_rate)
+            print("%-20s %-8s %14.4e %14.4e %10.2f" %
+                  (problem, name, rate, hydro_rate, wall))
+        print("%-20s speedup of the hydro update rate: %.2f" %
+              (problem, rates[1] / max(rates[0], 1e-30)))
+
+if __name__ == "__main__":
+    main()